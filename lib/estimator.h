@@ -0,0 +1,375 @@
+/******************************************************************************
+ *                         TILECAL SIMULATOR
+ *
+ * Bernardo S. Peralva    <bernardo@iprj.uerj.br>
+ * Guilherme I. Gonçalves <ggoncalves@iprj.uerj.br>
+ *
+ * Copyright (C) 2018 Bernardo & Guilherme
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *   http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#ifndef TILECAL_LIB_ESTIMATOR_H
+#define TILECAL_LIB_ESTIMATOR_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "../utils/matrix.h"
+
+/*
+ * Vector operations used by the estimation kernel. The generic version
+ * handles one window at a time, and there are specializations for
+ * AVX2 and AVX-512, enabled when the code is compiled for them
+ * (e.g. -march=native).
+ */
+template <typename T>
+struct SimdOps
+{
+    typedef T V;
+    static const unsigned WIDTH = 1;
+
+    static V    zero()                  { return T(0); }
+    static V    set1(T _a)              { return _a; }
+    static V    load(const T* _p)       { return *_p; }
+    static void store(T* _p, V _a)      { *_p = _a; }
+    static V    add(V _a, V _b)         { return _a + _b; }
+    static V    fmadd(V _a, V _b, V _c) { return _a * _b + _c; }
+};
+
+#if defined(__AVX512F__)
+
+template <>
+struct SimdOps<double>
+{
+    typedef __m512d V;
+    static const unsigned WIDTH = 8;
+
+    static V    zero()                  { return _mm512_setzero_pd(); }
+    static V    set1(double _a)         { return _mm512_set1_pd(_a); }
+    static V    load(const double* _p)  { return _mm512_loadu_pd(_p); }
+    static void store(double* _p, V _a) { _mm512_storeu_pd(_p, _a); }
+    static V    add(V _a, V _b)         { return _mm512_add_pd(_a, _b); }
+    static V    fmadd(V _a, V _b, V _c) { return _mm512_fmadd_pd(_a, _b, _c); }
+};
+
+template <>
+struct SimdOps<float>
+{
+    typedef __m512 V;
+    static const unsigned WIDTH = 16;
+
+    static V    zero()                  { return _mm512_setzero_ps(); }
+    static V    set1(float _a)          { return _mm512_set1_ps(_a); }
+    static V    load(const float* _p)   { return _mm512_loadu_ps(_p); }
+    static void store(float* _p, V _a)  { _mm512_storeu_ps(_p, _a); }
+    static V    add(V _a, V _b)         { return _mm512_add_ps(_a, _b); }
+    static V    fmadd(V _a, V _b, V _c) { return _mm512_fmadd_ps(_a, _b, _c); }
+};
+
+inline const char* simdName() { return "AVX-512"; }
+
+#elif defined(__AVX2__)
+
+template <>
+struct SimdOps<double>
+{
+    typedef __m256d V;
+    static const unsigned WIDTH = 4;
+
+    static V    zero()                  { return _mm256_setzero_pd(); }
+    static V    set1(double _a)         { return _mm256_set1_pd(_a); }
+    static V    load(const double* _p)  { return _mm256_loadu_pd(_p); }
+    static void store(double* _p, V _a) { _mm256_storeu_pd(_p, _a); }
+    static V    add(V _a, V _b)         { return _mm256_add_pd(_a, _b); }
+#if defined(__FMA__)
+    static V    fmadd(V _a, V _b, V _c) { return _mm256_fmadd_pd(_a, _b, _c); }
+#else
+    static V    fmadd(V _a, V _b, V _c) { return _mm256_add_pd(_mm256_mul_pd(_a, _b), _c); }
+#endif
+};
+
+template <>
+struct SimdOps<float>
+{
+    typedef __m256 V;
+    static const unsigned WIDTH = 8;
+
+    static V    zero()                  { return _mm256_setzero_ps(); }
+    static V    set1(float _a)          { return _mm256_set1_ps(_a); }
+    static V    load(const float* _p)   { return _mm256_loadu_ps(_p); }
+    static void store(float* _p, V _a)  { _mm256_storeu_ps(_p, _a); }
+    static V    add(V _a, V _b)         { return _mm256_add_ps(_a, _b); }
+#if defined(__FMA__)
+    static V    fmadd(V _a, V _b, V _c) { return _mm256_fmadd_ps(_a, _b, _c); }
+#else
+    static V    fmadd(V _a, V _b, V _c) { return _mm256_add_ps(_mm256_mul_ps(_a, _b), _c); }
+#endif
+};
+
+inline const char* simdName() { return "AVX2"; }
+
+#else
+
+inline const char* simdName() { return "scalar"; }
+
+#endif
+
+/*
+ * Weights of the three estimators, for a window of WINDOW samples:
+ *  - OF (Optimal Filter), without bias
+ *  - General Wiener-Hopf, with the bias at wg[WINDOW]
+ *  - Optimal Wiener-Hopf of each BCID, the weights of the BCID "b"
+ *    start at wo[(b - 1) * (WINDOW + 1)], with the bias at the end
+ */
+template <unsigned WINDOW, typename T>
+struct EstimatorWeights
+{
+    int            nbcid = 0;
+    T              of2[WINDOW];
+    T              wg[WINDOW + 1];
+    std::vector<T> wo;
+};
+
+/*
+ * This function loads the estimator weights, in the layout of the
+ * weight files: OF and General Wiener-Hopf vectors, and one row for
+ * each BCID with the BCID, the Optimal Wiener-Hopf weights and the bias.
+ * The rows of the BCIDs 1 to _nbcid must come first, in order.
+ *
+ * @param _of2 OF weights
+ * @param _wg General Wiener-Hopf weights
+ * @param _wo Optimal Wiener-Hopf weights
+ * @param _nbcid Number of BCIDs to be estimated
+ * @param _weights Output estimator weights
+ */
+template <unsigned WINDOW, typename T>
+void loadEstimatorWeights(
+    const Vector&                _of2,
+    const Vector&                _wg,
+    const Matrix&                _wo,
+    const int&                   _nbcid,
+    EstimatorWeights<WINDOW, T>& _weights)
+{
+    if (_of2.size() < WINDOW
+            || _wg.size() < WINDOW + 1
+            || _wo.cols() < WINDOW + 2)
+    {
+        throw std::invalid_argument( "weights do not match the window size" );
+    }
+
+    if (_nbcid < 1 || _wo.rows() < size_t(_nbcid))
+    {
+        throw std::invalid_argument( "missing Optimal Wiener-Hopf weights of some BCIDs" );
+    }
+
+    for (int b = 0; b < _nbcid; b++)
+    {
+        if (_wo[b][0] != b + 1)
+            throw std::invalid_argument( "Optimal Wiener-Hopf weights are not in BCID order" );
+    }
+
+    for (unsigned k = 0; k < WINDOW; k++)
+        _weights.of2[k] = T(_of2[k]);
+
+    for (unsigned k = 0; k <= WINDOW; k++)
+        _weights.wg[k] = T(_wg[k]);
+
+    _weights.nbcid = _nbcid;
+    _weights.wo.resize(size_t(_weights.nbcid) * (WINDOW + 1));
+
+    for (int b = 0; b < _weights.nbcid; b++)
+        for (unsigned k = 0; k <= WINDOW; k++)
+            _weights.wo[b * (WINDOW + 1) + k] = T(_wo[b][k + 1]);
+}
+
+/*
+ * This function applies the three estimators to a batch of windows of
+ * the same BCID, in a single pass: each window sample is loaded once
+ * and accumulated in the three inner products.
+ *
+ * The windows are in a structure of arrays: the sample "j" of the
+ * window "n" is _windows[j * _count + n].
+ *
+ * @param _weights Estimator weights
+ * @param _bcid BCID of the windows, in [1, nbcid]
+ * @param _windows Batch of windows
+ * @param _count Number of windows
+ * @param _ampWO Output Optimal Wiener-Hopf amplitudes
+ * @param _ampWG Output General Wiener-Hopf amplitudes
+ * @param _ampOF2 Output OF amplitudes
+ */
+template <unsigned WINDOW, typename T>
+void estimateBatch(
+    const EstimatorWeights<WINDOW, T>& _weights,
+    const int&                         _bcid,
+    const T*                           _windows,
+    const unsigned&                    _count,
+    T*                                 _ampWO,
+    T*                                 _ampWG,
+    T*                                 _ampOF2)
+{
+    typedef SimdOps<T>    S;
+    typedef typename S::V V;
+
+    if (_bcid < 1 || _bcid > _weights.nbcid)
+    {
+        throw std::out_of_range( "BCID without estimator weights" );
+    }
+
+    const T* wo = &_weights.wo[size_t(_bcid - 1) * (WINDOW + 1)];
+    const T* wg = _weights.wg;
+    const T* of = _weights.of2;
+
+    V vwo[WINDOW], vwg[WINDOW], vof[WINDOW];
+    for (unsigned k = 0; k < WINDOW; k++)
+    {
+        vwo[k] = S::set1(wo[k]);
+        vwg[k] = S::set1(wg[k]);
+        vof[k] = S::set1(of[k]);
+    }
+
+    const V woBias = S::set1(wo[WINDOW]);
+    const V wgBias = S::set1(wg[WINDOW]);
+
+    unsigned n = 0;
+    for (; n + S::WIDTH <= _count; n += S::WIDTH)
+    {
+        V accWO  = S::zero();
+        V accWG  = S::zero();
+        V accOF2 = S::zero();
+
+        for (unsigned k = 0; k < WINDOW; k++)
+        {
+            V x = S::load(_windows + size_t(k) * _count + n);
+            accWO  = S::fmadd(vwo[k], x, accWO);
+            accWG  = S::fmadd(vwg[k], x, accWG);
+            accOF2 = S::fmadd(vof[k], x, accOF2);
+        }
+
+        S::store(_ampWO + n, S::add(accWO, woBias));
+        S::store(_ampWG + n, S::add(accWG, wgBias));
+        S::store(_ampOF2 + n, accOF2);
+    }
+
+    // remaining windows
+    for (; n < _count; n++)
+    {
+        T accWO  = 0;
+        T accWG  = 0;
+        T accOF2 = 0;
+
+        for (unsigned k = 0; k < WINDOW; k++)
+        {
+            T x = _windows[size_t(k) * _count + n];
+            accWO  += wo[k] * x;
+            accWG  += wg[k] * x;
+            accOF2 += of[k] * x;
+        }
+
+        _ampWO[n]  = accWO + wo[WINDOW];
+        _ampWG[n]  = accWG + wg[WINDOW];
+        _ampOF2[n] = accOF2;
+    }
+}
+
+/*
+ * Estimation kernel of a window size chosen at run time, with the
+ * arguments of estimateBatch after the weights: BCID, windows, number
+ * of windows and the WO, WG and OF amplitudes.
+ */
+template <typename T>
+using WindowEstimator = std::function<void(const int&, const T*, const unsigned&, T*, T*, T*)>;
+
+/*
+ * Largest window size supported by makeWindowEstimator.
+ */
+const unsigned MAX_WINDOW_SIZE = 15;
+
+/*
+ * Factory of the kernels of each window size, from MAX_WINDOW_SIZE
+ * down to one, so each size is dispatched to its own instance of
+ * estimateBatch.
+ */
+template <typename T, unsigned WINDOW>
+struct WindowEstimatorFactory
+{
+    static WindowEstimator<T> make(
+        const unsigned& _size,
+        const Vector&   _of2,
+        const Vector&   _wg,
+        const Matrix&   _wo,
+        const int&      _nbcid)
+    {
+        if (_size != WINDOW)
+            return WindowEstimatorFactory<T, WINDOW - 1>::make(_size, _of2, _wg, _wo, _nbcid);
+
+        auto weights = std::make_shared<EstimatorWeights<WINDOW, T>>();
+        loadEstimatorWeights(_of2, _wg, _wo, _nbcid, *weights);
+
+        return [weights](const int& _bcid, const T* _windows, const unsigned& _count,
+                         T* _ampWO, T* _ampWG, T* _ampOF2)
+        {
+            estimateBatch(*weights, _bcid, _windows, _count, _ampWO, _ampWG, _ampOF2);
+        };
+    }
+};
+
+template <typename T>
+struct WindowEstimatorFactory<T, 0>
+{
+    static WindowEstimator<T> make(
+        const unsigned&,
+        const Vector&,
+        const Vector&,
+        const Matrix&,
+        const int&)
+    {
+        throw std::invalid_argument( "unsupported window size" );
+    }
+};
+
+/*
+ * This function builds the estimation kernel of a window size given at
+ * run time, in [1, MAX_WINDOW_SIZE]. The weights are in the layout of
+ * loadEstimatorWeights.
+ *
+ * Since the windows of a batch are stored sample by sample, the kernel
+ * of a sub-window of a batch takes the batch pointer shifted by the
+ * sub-window offset times the number of windows, without any copy.
+ *
+ * @param _size Window samples length
+ * @param _of2 OF weights
+ * @param _wg General Wiener-Hopf weights
+ * @param _wo Optimal Wiener-Hopf weights
+ * @param _nbcid Number of BCIDs to be estimated
+ */
+template <typename T>
+WindowEstimator<T> makeWindowEstimator(
+    const unsigned& _size,
+    const Vector&   _of2,
+    const Vector&   _wg,
+    const Matrix&   _wo,
+    const int&      _nbcid)
+{
+    return WindowEstimatorFactory<T, MAX_WINDOW_SIZE>::make(_size, _of2, _wg, _wo, _nbcid);
+}
+
+#endif
@@ -0,0 +1,176 @@
+/******************************************************************************
+ *                         TILECAL SIMULATOR
+ *
+ * Bernardo S. Peralva    <bernardo@iprj.uerj.br>
+ * Guilherme I. Gonçalves <ggoncalves@iprj.uerj.br>
+ *
+ * Copyright (C) 2018 Bernardo & Guilherme
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *   http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#ifndef TILECAL_LIB_EVALUATION_H
+#define TILECAL_LIB_EVALUATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "pulses.h"
+#include "random.h"
+#include "wiener.h"
+#include "estimator.h"
+#include "../utils/matrix.h"
+#include "../utils/bcid.h"
+
+/*
+ * A chunk of consecutive samples of a BCID. Each chunk is evaluated by
+ * a single thread, with its own random stream.
+ */
+struct BcidChunk
+{
+    int      bcid;
+    int      first;
+    int      count;
+    uint64_t stream;
+};
+
+/*
+ * Windows of a chunk with known signals, sample by sample as in
+ * estimateBatch, and the buffers of their estimations. The buffers of
+ * a thread are reused by all of its chunks.
+ */
+struct EvaluationBatch
+{
+    PulseBatch          pulses;
+    std::vector<double> windows;
+    std::vector<double> aproxWO;
+    std::vector<double> aproxWG;
+    std::vector<double> aproxOF2;
+};
+
+/*
+ * Evaluator of a chunk, called with the chunk position and its batch,
+ * already filled. The chunks are evaluated concurrently, so it must
+ * only write in the results of its own chunk.
+ */
+typedef std::function<void(const size_t& _position, const BcidChunk& _chunk, EvaluationBatch& _batch)> ChunkEvaluator;
+
+/*
+ * This function splits the samples of each BCID in chunks of fixed
+ * size, ordered by BCID and by position. The random stream of a chunk
+ * only depends on its BCID and position.
+ *
+ * @param _index Samples partitioned by BCID
+ * @param _nbcid Number of BCIDs
+ * @param _chunkSize Number of samples of each chunk
+ * @param _chunks Output chunks
+ */
+void splitbcidchunks(
+    const BcidIndex&        _index,
+    const int&              _nbcid,
+    const int&              _chunkSize,
+    std::vector<BcidChunk>& _chunks);
+
+/*
+ * This function adds signals of known amplitude to consecutive noise
+ * rows, in the windows of a batch, and sizes its estimation buffers.
+ *
+ * @param _noises Noise rows
+ * @param _first First row
+ * @param _count Number of rows
+ * @param _firstSampleColumn Column of the first window sample in each row
+ * @param _table Shaper table, with the window length
+ * @param _generator Random numbers generator
+ * @param _batch Output batch
+ */
+void fillevaluationbatch(
+    const Matrix&      _noises,
+    const unsigned&    _first,
+    const unsigned&    _count,
+    const unsigned&    _firstSampleColumn,
+    const ShaperTable& _table,
+    Random&            _generator,
+    EvaluationBatch&   _batch);
+
+/*
+ * This function evaluates the chunks with a pool of threads, each one
+ * taking the next pending chunk. The batch of a chunk is filled from
+ * the noises of its BCID, with the signals of a random stream derived
+ * from the seed and the chunk stream.
+ *
+ * The results of each chunk are merged by the caller in the chunk
+ * order, so they only depend on the seed, and not on the number of
+ * threads.
+ *
+ * @param _index Noises partitioned by BCID
+ * @param _firstSampleColumn Column of the first window sample in each row
+ * @param _table Shaper table, with the window length
+ * @param _chunks Chunks of the noises
+ * @param _nthreads Number of threads, at least one is used
+ * @param _seed Seed of the random streams
+ * @param _evaluate Evaluator of each chunk
+ */
+void evaluatechunks(
+    BcidIndex&                    _index,
+    const unsigned&               _firstSampleColumn,
+    const ShaperTable&            _table,
+    const std::vector<BcidChunk>& _chunks,
+    const unsigned&               _nthreads,
+    const uint64_t&               _seed,
+    const ChunkEvaluator&         _evaluate);
+
+/*
+ * This function solves the Wiener-Hopf models of a bank and loads them,
+ * with the OF weights, in the estimator weights. The window length of
+ * the bank must be WINDOW.
+ *
+ * @param _of2 OF weights
+ * @param _bank Bank of accumulators, already trained
+ * @param _weights Output estimator weights
+ */
+template <unsigned WINDOW, typename T>
+void loadBankWeights(
+    const Vector&                _of2,
+    const WienerBank&            _bank,
+    EstimatorWeights<WINDOW, T>& _weights)
+{
+    Vector weightsWG;
+    Matrix weightsWO;
+    wienerbanksolve(_bank, weightsWG, weightsWO);
+
+    loadEstimatorWeights(_of2, weightsWG, weightsWO, int(_bank.bcids.size()), _weights);
+}
+
+/*
+ * This function solves the Wiener-Hopf models of a bank and builds the
+ * estimation kernel of its window length, given at run time.
+ *
+ * @param _of2 OF weights
+ * @param _bank Bank of accumulators, already trained
+ */
+template <typename T>
+WindowEstimator<T> makeBankEstimator(
+    const Vector&     _of2,
+    const WienerBank& _bank)
+{
+    Vector weightsWG;
+    Matrix weightsWO;
+    wienerbanksolve(_bank, weightsWG, weightsWO);
+
+    return makeWindowEstimator<T>(unsigned(weightsWG.size() - 1), _of2, weightsWG, weightsWO,
+                                  int(_bank.bcids.size()));
+}
+
+#endif
@@ -0,0 +1,50 @@
+/******************************************************************************
+ *                         TILECAL SIMULATOR
+ *
+ * Bernardo S. Peralva    <bernardo@iprj.uerj.br>
+ * Guilherme I. Gonçalves <ggoncalves@iprj.uerj.br>
+ *
+ * Copyright (C) 2018 Bernardo & Guilherme
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *   http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#ifndef TILECAL_LIB_NOISE_H
+#define TILECAL_LIB_NOISE_H
+
+#include "random.h"
+#include "../utils/matrix.h"
+
+/*
+ * This function generates a random noise vector, following
+ * the normal distribution, whose mean and standard deviation
+ * are given by parameter.
+ * The value of the parameter _ped will be added to
+ * each noise sample.
+ *
+ * @param _size Noise samples length
+ * @param _mean Noise mean
+ * @param _stddev Noise standard deviation
+ * @param _ped Pedestal
+ * @param _generator Random numbers generator
+ * @param _noise Random noise vector generated
+ */
+void generateNoise(
+    const unsigned& _size,
+    const double&   _mean,
+    const double&   _stddev,
+    const double&   _ped,
+    Random&         _generator,
+    Vector&         _noise);
+
+#endif
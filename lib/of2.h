@@ -0,0 +1,50 @@
+/******************************************************************************
+ *                         TILECAL SIMULATOR
+ *
+ * Bernardo S. Peralva    <bernardo@iprj.uerj.br>
+ * Guilherme I. Gonçalves <ggoncalves@iprj.uerj.br>
+ *
+ * Copyright (C) 2018 Bernardo & Guilherme
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *   http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#ifndef TILECAL_LIB_OF2_H
+#define TILECAL_LIB_OF2_H
+
+#include "../utils/matrix.h"
+
+/*
+ * This function calculates the OF (Optimal Filter) weights of a readout
+ * window, for white noise: the weights of minimum norm whose inner
+ * product with the pulse shape is one, and with its derivative and with
+ * a constant pedestal is zero.
+ *
+ * @param _size Window samples length
+ * @param _pulseIndex Window sample of the pulse peak
+ * @param _samplingRate Sampling rate in nanoseconds
+ * @param _shaper Vector with eletronic signal shaper
+ * @param _shaperResolution Shaper resolution in nanoseconds
+ * @param _shaperZeroIndex Shaper index of time series zero
+ * @param _weights Output weights
+ */
+void of2weights(
+    const unsigned& _size,
+    const unsigned& _pulseIndex,
+    const double&   _samplingRate,
+    const Vector&   _shaper,
+    const double&   _shaperResolution,
+    const unsigned& _shaperZeroIndex,
+    Vector&         _weights);
+
+#endif
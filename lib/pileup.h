@@ -0,0 +1,63 @@
+/******************************************************************************
+ *                         TILECAL SIMULATOR
+ *
+ * Bernardo S. Peralva    <bernardo@iprj.uerj.br>
+ * Guilherme I. Gonçalves <ggoncalves@iprj.uerj.br>
+ *
+ * Copyright (C) 2018 Bernardo & Guilherme
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *   http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#ifndef TILECAL_LIB_PILEUP_H
+#define TILECAL_LIB_PILEUP_H
+
+#include "random.h"
+#include "../utils/matrix.h"
+
+/*
+ * This function generates a pileup noise vector.
+ * For each sample position, there is a probability of _prob x 100%
+ * to generate a pileup signal, which will be added to a resultant
+ * pileup vector.
+ *
+ * @param _size Signal samples length
+ * @param _phaseMean Phase mean
+ * @param _phaseStddev Phase standard deviation
+ * @param _defMean Deformation mean
+ * @param _defStddev Deformation standard deviation
+ * @param _ped Pedestal
+ * @param _shaper Vector with eletronic signal shaper
+ * @param _shaperResolution Shaper resolution in nanoseconds
+ * @param _shaperZeroIndex Shaper index of time series zero
+ * @param _samplingRate Sampling rate in nanoseconds
+ * @param _prob Probability of generate a pileup in a sample position [0.0;1.0]
+ * @param _generator Random numbers generator
+ * @param _pileup Random pileup vector generated
+ */
+void generatePileup(
+    const unsigned& _size,
+    const double&   _phaseMean,
+    const double&   _phaseStddev,
+    const double&   _defMean,
+    const double&   _defStddev,
+    const double&   _ped,
+    const Vector&   _shaper,
+    const double&   _shaperResolution,
+    const unsigned& _shaperZeroIndex,
+    const unsigned& _samplingRate,
+    const double&   _prob,
+    Random&         _generator,
+    Vector&         _pileup);
+
+#endif
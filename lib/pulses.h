@@ -0,0 +1,167 @@
+/******************************************************************************
+ *                         TILECAL SIMULATOR
+ *
+ * Bernardo S. Peralva    <bernardo@iprj.uerj.br>
+ * Guilherme I. Gonçalves <ggoncalves@iprj.uerj.br>
+ *
+ * Copyright (C) 2018 Bernardo & Guilherme
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *   http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#ifndef TILECAL_LIB_PULSES_H
+#define TILECAL_LIB_PULSES_H
+
+#include <vector>
+
+#include "random.h"
+#include "../utils/matrix.h"
+
+/*
+ * Shaper samples of a readout window, tabulated for every shift of the
+ * pulse in shaper bins.
+ *
+ * The shaper index of a window sample only depends on the pulse phase
+ * bin minus its lag bin, so each (phase bin, lag) pair is a single row
+ * of this table, with the window samples of the pulse. The rows cover
+ * every shift that reaches the shaper, the shifts out of the table
+ * give the same samples of its first or last row.
+ */
+struct ShaperTable
+{
+    unsigned            size         = 0;
+    double              resolution   = 0;
+    double              samplingRate = 0;
+    int                 minOffset    = 0;
+    int                 noffsets     = 0;
+    std::vector<double> samples;
+};
+
+/*
+ * Pulses generated by batch, in a structure of arrays: the sample "j"
+ * of the pulse "n" is samples[j * count + n], so each window sample is
+ * contiguous along the batch.
+ */
+struct PulseBatch
+{
+    unsigned            size  = 0;
+    unsigned            count = 0;
+    std::vector<double> amplitude;
+    std::vector<double> phase;
+    std::vector<double> samples;
+    std::vector<int>    rows;
+};
+
+/*
+ * This function tabulates the shaper samples of a readout window.
+ *
+ * @param _size Signal samples length
+ * @param _samplingRate Sampling rate in nanoseconds
+ * @param _shaper Vector with eletronic signal shaper
+ * @param _shaperResolution Shaper resolution in nanoseconds
+ * @param _shaperZeroIndex Shaper index of time series zero
+ * @param _table Output shaper table
+ */
+void buildShaperTable(
+    const unsigned& _size,
+    const double&   _samplingRate,
+    const Vector&   _shaper,
+    const double&   _shaperResolution,
+    const unsigned& _shaperZeroIndex,
+    ShaperTable&    _table);
+
+/*
+ * This function gives the table row of a pulse shift.
+ *
+ * @param _table Shaper table
+ * @param _phase Pulse phase in nanoseconds
+ * @param _lag Pulse lag in nanoseconds
+ */
+int shaperTableRow(
+    const ShaperTable& _table,
+    const double&      _phase,
+    const double&      _lag);
+
+/*
+ * This function allocates a batch of pulses. Allocating a batch with the
+ * same or a smaller size does not allocate memory again.
+ *
+ * @param _size Signal samples length
+ * @param _count Number of pulses
+ * @param _batch Batch of pulses
+ */
+void allocateBatch(
+    const unsigned& _size,
+    const unsigned& _count,
+    PulseBatch&     _batch);
+
+/*
+ * This function generates a batch of random signals, following the
+ * same model of generateSignal: a random amplitude between [0,1023]
+ * multiplied by the signal shape with a random phase, plus a pedestal
+ * and a random deformation of each sample.
+ *
+ * The random values are drawn first, and then each window sample is
+ * computed along the whole batch from the shaper table.
+ *
+ * @param _table Shaper table, with the batch signal length
+ * @param _phaseMean Phase mean
+ * @param _phaseStddev Phase standard deviation
+ * @param _defMean Deformation mean
+ * @param _defStddev Deformation standard deviation
+ * @param _ped Pedestal
+ * @param _lag Signal lag in nanoseconds
+ * @param _generator Random numbers generator
+ * @param _batch Batch of pulses, already allocated
+ */
+void generateSignals(
+    const ShaperTable& _table,
+    const double&      _phaseMean,
+    const double&      _phaseStddev,
+    const double&      _defMean,
+    const double&      _defStddev,
+    const double&      _ped,
+    const double&      _lag,
+    Random&            _generator,
+    PulseBatch&        _batch);
+
+/*
+ * This function generates a batch of pileup noise vectors, following
+ * the same model of generatePileup: for each sample position, there is
+ * a probability of _prob x 100% to generate a pileup signal lagged to
+ * that position, which is added to the pulse.
+ * The batch amplitude is the sum of the pileup amplitudes of each pulse,
+ * and its phase is not set.
+ *
+ * @param _table Shaper table, with the batch signal length
+ * @param _phaseMean Phase mean
+ * @param _phaseStddev Phase standard deviation
+ * @param _defMean Deformation mean
+ * @param _defStddev Deformation standard deviation
+ * @param _ped Pedestal
+ * @param _prob Probability of generate a pileup in a sample position [0.0;1.0]
+ * @param _generator Random numbers generator
+ * @param _batch Batch of pulses, already allocated
+ */
+void generatePileups(
+    const ShaperTable& _table,
+    const double&      _phaseMean,
+    const double&      _phaseStddev,
+    const double&      _defMean,
+    const double&      _defStddev,
+    const double&      _ped,
+    const double&      _prob,
+    Random&            _generator,
+    PulseBatch&        _batch);
+
+#endif
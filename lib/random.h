@@ -0,0 +1,92 @@
+/******************************************************************************
+ *                         TILECAL SIMULATOR
+ *
+ * Bernardo S. Peralva    <bernardo@iprj.uerj.br>
+ * Guilherme I. Gonçalves <ggoncalves@iprj.uerj.br>
+ *
+ * Copyright (C) 2018 Bernardo & Guilherme
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *   http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#ifndef TILECAL_LIB_RANDOM_H
+#define TILECAL_LIB_RANDOM_H
+
+#include <cstdint>
+
+/*
+ * Random numbers generator (xoshiro256**), with the distributions used
+ * by the simulation. The sequence of a seed is the same on every
+ * platform, so results are reproducible.
+ */
+class Random
+{
+public:
+    explicit Random(uint64_t _seed = 0);
+
+    /*
+     * Restarts the sequence of the generator from a seed.
+     */
+    void SetSeed(uint64_t _seed);
+
+    /*
+     * Uniform random value in (0, 1).
+     */
+    double Rndm();
+
+    /*
+     * Uniform random value in (_a, _b).
+     */
+    double Uniform(double _a, double _b);
+
+    /*
+     * Uniform random integer in [0, _n - 1].
+     */
+    unsigned Integer(unsigned _n);
+
+    /*
+     * Normal random value.
+     */
+    double Gaus(double _mean = 0.0, double _sigma = 1.0);
+
+    /*
+     * Exponential random value, with mean _tau.
+     */
+    double Exp(double _tau);
+
+    /*
+     * Poisson random value.
+     */
+    unsigned Poisson(double _mean);
+
+private:
+    uint64_t next();
+
+    uint64_t m_state[4];
+};
+
+/*
+ * This function derives the seed of an independent random stream from
+ * a base seed and a stream identifier, mixing both with SplitMix64.
+ * Streams with different identifiers give uncorrelated seeds, so work
+ * can be split in chunks, each one with its own generator, and the
+ * result does not depend on which thread runs each chunk.
+ *
+ * @param _seed Base seed
+ * @param _stream Stream identifier
+ */
+uint64_t streamseed(
+    const uint64_t& _seed,
+    const uint64_t& _stream);
+
+#endif
@@ -0,0 +1,70 @@
+/******************************************************************************
+ *                         TILECAL SIMULATOR
+ *
+ * Bernardo S. Peralva    <bernardo@iprj.uerj.br>
+ * Guilherme I. Gonçalves <ggoncalves@iprj.uerj.br>
+ *
+ * Copyright (C) 2018 Bernardo & Guilherme
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *   http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#ifndef TILECAL_LIB_SIGNAL_H
+#define TILECAL_LIB_SIGNAL_H
+
+#include "random.h"
+#include "../utils/matrix.h"
+
+/*
+ * This function generates a random signal vector.
+ * The signal is composed by the multiplication of a random amplitude
+ * value with a signal shape. After that, a pedestal is added to the signal.
+ * Both amplitude and phase are random values. The amplitude follows the uniform
+ * distribution, whose range is between 0 to 1023. The phase follows the normal
+ * distribution, whose mean and standard deviation are given by parameter.
+ * There is a deformation of each signal sample, which is a random value also,
+ * following the normal distribution, whose mean and standard deviation
+ * are given by parameter.
+ *
+ * @param _size Signal samples length
+ * @param _phaseMean Phase mean
+ * @param _phaseStddev Phase standard deviation
+ * @param _defMean Deformation mean
+ * @param _defStddev Deformation standard deviation
+ * @param _ped Pedestal
+ * @param _lag Signal lag in nanoseconds
+ * @param _shaper Vector with eletronic signal shaper
+ * @param _shaperResolution Shaper resolution in nanoseconds
+ * @param _shaperZeroIndex Shaper index of time series zero
+ * @param _generator Random numbers generator
+ * @param _amplitude Random amplitude value generated
+ * @param _phase Random phase value generated
+ * @param _signal Random signal vector generated
+ */
+void generateSignal(
+    const unsigned& _size,
+    const double&   _phaseMean,
+    const double&   _phaseStddev,
+    const double&   _defMean,
+    const double&   _defStddev,
+    const double&   _ped,
+    const double&   _lag,
+    const Vector&   _shaper,
+    const double&   _shaperResolution,
+    const unsigned& _shaperZeroIndex,
+    Random&         _generator,
+    double&         _amplitude,
+    double&         _phase,
+    Vector&         _signal);
+
+#endif
@@ -0,0 +1,115 @@
+/******************************************************************************
+ *                         TILECAL SIMULATOR
+ *
+ * Bernardo S. Peralva    <bernardo@iprj.uerj.br>
+ * Guilherme I. Gonçalves <ggoncalves@iprj.uerj.br>
+ *
+ * Copyright (C) 2018 Bernardo & Guilherme
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *   http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#ifndef TILECAL_LIB_TRAIN_H
+#define TILECAL_LIB_TRAIN_H
+
+#include <cstdint>
+#include <functional>
+
+#include "pulses.h"
+#include "random.h"
+#include "../utils/matrix.h"
+
+/*
+ * Layout of the windows given by the bunch train simulator: one window
+ * per row, with the BCID of its central sample at column
+ * TRAIN_BCID_COLUMN and the window samples from column
+ * TRAIN_FIRST_SAMPLE_COLUMN, as the rows of a noise dataset.
+ */
+const unsigned TRAIN_BCID_COLUMN         = 0;
+const unsigned TRAIN_FIRST_SAMPLE_COLUMN = 1;
+const unsigned TRAIN_BATCH_SIZE          = 4096;
+
+/*
+ * Bunch train pattern and pileup conditions of a simulation.
+ *
+ * The crossings repeat the pattern of "trainLength" filled crossings,
+ * labelled BCID 1 to trainLength, followed by "gapLength" empty ones.
+ * Each filled crossing has a Poisson number of pileup pulses, with mean
+ * "mu", whose amplitudes follow the exponential distribution.
+ */
+struct TrainConfig
+{
+    unsigned trainLength   = 40;
+    unsigned gapLength     = 8;
+    double   mu            = 200;
+    double   amplitudeMean = 2.0;
+    double   phaseMean     = 0.0;
+    double   phaseStddev   = 0.0;
+    double   pedestal      = 0.0;
+    double   noiseStddev   = 1.5;
+};
+
+/*
+ * Consumer of the windows of a simulation. It is called with batches of
+ * up to TRAIN_BATCH_SIZE windows, which are only valid during the call.
+ */
+typedef std::function<void(const Matrix& _windows)> TrainConsumer;
+
+/*
+ * This function tabulates the samples of a pulse at its crossing and
+ * at the neighbour ones, wide enough to hold the whole shaper.
+ * The row of a pulse is given by shaperTableRow(kernel, phase, 0), and
+ * its sample "i" is added to the crossing (i - kernel.size / 2) after
+ * the pulse one.
+ *
+ * @param _samplingRate Sampling rate in nanoseconds
+ * @param _shaper Vector with eletronic signal shaper
+ * @param _shaperResolution Shaper resolution in nanoseconds
+ * @param _shaperZeroIndex Shaper index of time series zero
+ * @param _kernel Output pulse table
+ */
+void buildTrainKernel(
+    const double&   _samplingRate,
+    const Vector&   _shaper,
+    const double&   _shaperResolution,
+    const unsigned& _shaperZeroIndex,
+    ShaperTable&    _kernel);
+
+/*
+ * This function simulates the digitized samples of a cell along a
+ * continuous sequence of bunch crossings, one sample per crossing, and
+ * gives the readout window centered at each filled crossing.
+ *
+ * The pulses of a crossing are added to a ring buffer with the samples
+ * they reach, so each pulse costs kernel.size additions, and a sample
+ * leaves the buffer as soon as no later pulse can reach it. Without
+ * phase spread, the pulses of a crossing have the same shape, so their
+ * amplitudes are summed and the shape is added once.
+ * Each sample gets the pedestal and a normal electronic noise.
+ *
+ * @param _config Bunch train pattern and pileup conditions
+ * @param _kernel Pulse table, built by buildTrainKernel
+ * @param _windowSize Window samples length
+ * @param _ncrossings Number of crossings to simulate
+ * @param _generator Random numbers generator
+ * @param _consumer Consumer of the windows
+ */
+void simulatetrain(
+    const TrainConfig&   _config,
+    const ShaperTable&   _kernel,
+    const unsigned&      _windowSize,
+    const uint64_t&      _ncrossings,
+    Random&              _generator,
+    const TrainConsumer& _consumer);
+
+#endif
@@ -0,0 +1,82 @@
+/******************************************************************************
+ *                         TILECAL SIMULATOR
+ *
+ * Bernardo S. Peralva    <bernardo@iprj.uerj.br>
+ * Guilherme I. Gonçalves <ggoncalves@iprj.uerj.br>
+ *
+ * Copyright (C) 2018 Bernardo & Guilherme
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *   http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#ifndef TILECAL_LIB_TRAINING_H
+#define TILECAL_LIB_TRAINING_H
+
+#include <cstdint>
+
+#include "pulses.h"
+#include "random.h"
+#include "wiener.h"
+#include "../utils/matrix.h"
+
+/*
+ * This function trains the Wiener-Hopf models of a bank in a single
+ * pass over a noise dataset. For each event, a random signal is added
+ * to the noise window, and the resulting window is accumulated in the
+ * general model and in the model of the event BCID. The design matrix
+ * is never built, so the memory does not grow with the dataset.
+ * The signals are generated by batches, from the shaper table.
+ *
+ * Each observation is the window samples followed by a constant 1,
+ * whose weight is the estimator bias. Rows without a whole window
+ * after _firstSampleColumn are rejected.
+ *
+ * @param _noises Noise dataset, one event per row
+ * @param _bcidColumn Column of the BCID in each row
+ * @param _firstSampleColumn Column of the first window sample in each row
+ * @param _table Shaper table, with the window length
+ * @param _generator Random numbers generator
+ * @param _bank Bank of accumulators, already initialized
+ */
+void trainwiener(
+    const Matrix&      _noises,
+    const unsigned&    _bcidColumn,
+    const unsigned&    _firstSampleColumn,
+    const ShaperTable& _table,
+    Random&            _generator,
+    WienerBank&        _bank);
+
+/*
+ * This function trains the Wiener-Hopf models of every BCID and the
+ * general one in a single pass over a binary noise dataset, with the
+ * signals of a shaper file. It is the training shared by the weight
+ * drivers.
+ *
+ * @param _datasetPath Binary noise dataset path
+ * @param _shaperPath Shaper file path
+ * @param _windowSize Window samples length
+ * @param _samplingRate Sampling rate in nanoseconds
+ * @param _nbcid Number of BCIDs in the bunch train
+ * @param _seed Seed of the signals generator
+ * @param _bank Output bank of accumulators
+ */
+void trainwienerdataset(
+    const char*     _datasetPath,
+    const char*     _shaperPath,
+    const unsigned& _windowSize,
+    const double&   _samplingRate,
+    const int&      _nbcid,
+    const uint64_t& _seed,
+    WienerBank&     _bank);
+
+#endif
@@ -0,0 +1,195 @@
+/******************************************************************************
+ *                         TILECAL SIMULATOR
+ *
+ * Bernardo S. Peralva    <bernardo@iprj.uerj.br>
+ * Guilherme I. Gonçalves <ggoncalves@iprj.uerj.br>
+ *
+ * Copyright (C) 2018 Bernardo & Guilherme
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *   http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#ifndef TILECAL_LIB_WIENER_H
+#define TILECAL_LIB_WIENER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../utils/matrix.h"
+
+/*
+ * Sufficient statistics of a Wiener-Hopf model: the correlation
+ * matrix R = sum(x * x') and the cross-correlation vector p = sum(x * d),
+ * accumulated one observation at a time. Since R is symmetric, only its
+ * upper triangle is stored, packed by rows.
+ */
+struct WienerAccumulator
+{
+    int                 size  = 0;
+    int64_t             count = 0;
+    std::vector<double> R;
+    std::vector<double> p;
+};
+
+/*
+ * Models trained in the same pass: one for each BCID (Optimal
+ * Wiener-Hopf) and one for all the BCIDs (General Wiener-Hopf).
+ * The model of the BCID "b" is bcids[b - 1].
+ */
+struct WienerBank
+{
+    WienerAccumulator              general;
+    std::vector<WienerAccumulator> bcids;
+};
+
+/*
+ * This function resets an accumulator.
+ *
+ * @param _acc Accumulator
+ * @param _size Number of weights of the model
+ */
+void wienerinit(
+    WienerAccumulator& _acc,
+    const int&         _size);
+
+/*
+ * This function adds an observation to an accumulator.
+ *
+ * @param _acc Accumulator
+ * @param _x Observation, with acc.size elements
+ * @param _d Desired value
+ */
+void wieneraccumulate(
+    WienerAccumulator& _acc,
+    const double*      _x,
+    const double&      _d);
+
+/*
+ * This function merges the observations of an accumulator into
+ * another one, as if they were accumulated by it.
+ *
+ * @param _acc Accumulator
+ * @param _other Accumulator to be merged, with the same size
+ */
+void wienermerge(
+    WienerAccumulator&       _acc,
+    const WienerAccumulator& _other);
+
+/*
+ * This function solves the Wiener-Hopf equation R * w = p of an
+ * accumulator. R is factorized as L * D * L' (LDL'), which exploits its
+ * symmetry and avoids the explicit inversion.
+ * An accumulator without observations gives null weights.
+ *
+ * @param _acc Accumulator
+ * @param _weights Output weights
+ */
+void wienersolve(
+    const WienerAccumulator& _acc,
+    Vector&                  _weights);
+
+/*
+ * This function resets a bank of accumulators.
+ *
+ * @param _bank Bank of accumulators
+ * @param _size Number of weights of each model
+ * @param _nbcid Number of BCIDs in the bunch train
+ */
+void wienerbankinit(
+    WienerBank& _bank,
+    const int&  _size,
+    const int&  _nbcid);
+
+/*
+ * This function adds an observation to the general model and to the
+ * model of its BCID. Observations of BCIDs out of the bank range only
+ * contribute to the general model.
+ *
+ * @param _bank Bank of accumulators
+ * @param _bcid Observation BCID
+ * @param _x Observation
+ * @param _d Desired value
+ */
+void wienerbankaccumulate(
+    WienerBank&   _bank,
+    const int&    _bcid,
+    const double* _x,
+    const double& _d);
+
+/*
+ * This function merges a bank of accumulators into another one.
+ *
+ * @param _bank Bank of accumulators
+ * @param _other Bank to be merged, with the same sizes
+ */
+void wienerbankmerge(
+    WienerBank&       _bank,
+    const WienerBank& _other);
+
+/*
+ * This function extracts the statistics of a model with a subset of
+ * the observation elements. The correlations of the subset are a block
+ * of R and p, so the smaller model needs no other pass over the data:
+ * e.g. the elements of a shorter readout window and the bias.
+ *
+ * @param _acc Accumulator of the full observations
+ * @param _indices Observation elements of the subset, in its order
+ * @param _out Output accumulator, with _indices.size() elements
+ */
+void wienersubset(
+    const WienerAccumulator& _acc,
+    const std::vector<int>&  _indices,
+    WienerAccumulator&       _out);
+
+/*
+ * This function extracts the statistics of a subset of the observation
+ * elements from all the models of a bank.
+ *
+ * @param _bank Bank of accumulators of the full observations
+ * @param _indices Observation elements of the subset, in its order
+ * @param _out Output bank
+ */
+void wienerbanksubset(
+    const WienerBank&       _bank,
+    const std::vector<int>& _indices,
+    WienerBank&             _out);
+
+/*
+ * This function calculates the weights of all the models of a bank, in
+ * the layout of the weight files: the general weights, and one row for
+ * each BCID with the BCID followed by its weights. All the models are
+ * solved before anything is returned, so a singular model leaves the
+ * outputs untouched.
+ *
+ * @param _bank Bank of accumulators
+ * @param _general Output General Wiener-Hopf weights
+ * @param _bcids Output Optimal Wiener-Hopf weights, one row per BCID
+ */
+void wienerbanksolve(
+    const WienerBank& _bank,
+    Vector&           _general,
+    Matrix&           _bcids);
+
+/*
+ * This function calculates the Wiener-Hopf weights of a design matrix.
+ *
+ * @param _X Observations, one per row
+ * @param _d Desired values
+ * @param _weights Output weights
+ */
+void wiener(
+    const Matrix& _X,
+    const Vector& _d,
+    Vector&       _weights);
+
+#endif
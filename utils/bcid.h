@@ -0,0 +1,84 @@
+/******************************************************************************
+ *                         TILECAL SIMULATOR
+ *
+ * Bernardo S. Peralva    <bernardo@iprj.uerj.br>
+ * Guilherme I. Gonçalves <ggoncalves@iprj.uerj.br>
+ *
+ * Copyright (C) 2018 Bernardo & Guilherme
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *   http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#ifndef TILECAL_UTILS_BCID_H
+#define TILECAL_UTILS_BCID_H
+
+#include <vector>
+
+#include "matrix.h"
+
+/*
+ * Noise samples partitioned by BCID (bunch crossing identifier).
+ *
+ * All the rows are stored in a single buffer, grouped by BCID: the
+ * rows of the BCID "b" are the contiguous range [offsets[b], offsets[b + 1]).
+ * Rows whose BCID is out of [1, nbcid] are not indexed.
+ */
+struct BcidIndex
+{
+    int                 nbcid = 0;
+    int                 ncols = 0;
+    std::vector<double> rows;
+    std::vector<int>    offsets;
+};
+
+/*
+ * This function builds the BCID index of a noise samples matrix.
+ * It is a counting sort: the BCIDs are counted in a first scan and the
+ * rows are scattered to their partition in a second one, so the matrix
+ * is scanned twice in total, instead of once for each BCID.
+ *
+ * @param _input Noise samples matrix, one event per row
+ * @param _bcidColumn Column of the BCID in each row
+ * @param _nbcid Number of BCIDs in the bunch train
+ * @param _index Output BCID index
+ */
+void buildbcidindex(
+    const Matrix& _input,
+    const int&    _bcidColumn,
+    const int&    _nbcid,
+    BcidIndex&    _index);
+
+/*
+ * This function gives the number of rows of a BCID.
+ *
+ * @param _index BCID index
+ * @param _bcid BCID, in [1, nbcid]
+ */
+int bcidrows(
+    const BcidIndex& _index,
+    const int&       _bcid);
+
+/*
+ * This function gives a matrix view over the rows of a BCID, without
+ * copying them. The view is valid while the index is alive.
+ *
+ * @param _index BCID index
+ * @param _bcid BCID, in [1, nbcid]
+ * @param _slice Output matrix view
+ */
+void bcidslice(
+    BcidIndex& _index,
+    const int& _bcid,
+    Matrix&    _slice);
+
+#endif
@@ -0,0 +1,176 @@
+/******************************************************************************
+ *                         TILECAL SIMULATOR
+ *
+ * Bernardo S. Peralva    <bernardo@iprj.uerj.br>
+ * Guilherme I. Gonçalves <ggoncalves@iprj.uerj.br>
+ *
+ * Copyright (C) 2018 Bernardo & Guilherme
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *   http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#ifndef TILECAL_UTILS_CACHE_H
+#define TILECAL_UTILS_CACHE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "statistics.h"
+
+/*
+ * Binary result cache format.
+ *
+ * The evaluation writes, for each BCID and estimation method, the
+ * running statistics and the histogram of the estimation errors, so
+ * the figures are drawn from a single simulation:
+ *
+ *      | header (64 bytes) | BCID 1 | BCID 2 | ... | BCID nbcid |
+ *
+ * Each BCID holds the results of the methods in the order WO, WG and
+ * OF2. Each result is the count (int64), mean, m2, min and max
+ * (doubles), the underflow and overflow counts and the "nbins" bin
+ * counts (uint64), all native.
+ */
+const char     CACHE_MAGIC[8] = { 'T', 'I', 'L', 'E', 'R', 'S', 'L', 'T' };
+const uint32_t CACHE_VERSION  = 1;
+const unsigned CACHE_NMETHODS = 3;
+
+/*
+ * Estimation methods of the results of a BCID.
+ */
+enum CacheMethod
+{
+    CACHE_WO  = 0, // Optimal Wiener-Hopf
+    CACHE_WG  = 1, // General Wiener-Hopf
+    CACHE_OF2 = 2  // OF
+};
+
+struct CacheHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t nbcid;
+    uint32_t nmethods;
+    uint32_t nbins;
+    double   low;
+    double   high;
+    uint32_t reserved[6];
+};
+
+static_assert(sizeof(CacheHeader) == 64, "cache header must have 64 bytes");
+
+/*
+ * Estimation errors of a BCID, in GeV, for each method.
+ */
+struct BcidResults
+{
+    RunningStats stats[CACHE_NMETHODS];
+    Histogram    hist[CACHE_NMETHODS];
+};
+
+/*
+ * Results of all the BCIDs. The results of the BCID "b" are bcids[b - 1].
+ */
+struct ResultCache
+{
+    std::vector<BcidResults> bcids;
+};
+
+/*
+ * This function resets the results of a BCID.
+ *
+ * @param _results Results of a BCID
+ * @param _nbins Number of histogram bins
+ * @param _low Lower edge of the histograms, in GeV
+ * @param _high Upper edge of the histograms, in GeV
+ */
+void resultsinit(
+    BcidResults&    _results,
+    const unsigned& _nbins,
+    const double&   _low,
+    const double&   _high);
+
+/*
+ * This function adds the estimation errors of a window to the results
+ * of a BCID.
+ *
+ * @param _results Results of a BCID
+ * @param _errorWO Optimal Wiener-Hopf error, in GeV
+ * @param _errorWG General Wiener-Hopf error, in GeV
+ * @param _errorOF2 OF error, in GeV
+ */
+void resultsaccumulate(
+    BcidResults&  _results,
+    const double& _errorWO,
+    const double& _errorWG,
+    const double& _errorOF2);
+
+/*
+ * This function adds the results of other windows of the same BCID.
+ *
+ * @param _results Results of a BCID
+ * @param _other Results to add
+ */
+void resultsmerge(
+    BcidResults&       _results,
+    const BcidResults& _other);
+
+/*
+ * This function resets a cache, with the same histogram bins for all
+ * the BCIDs.
+ *
+ * @param _cache Result cache
+ * @param _nbcid Number of BCIDs
+ * @param _nbins Number of histogram bins
+ * @param _low Lower edge of the histograms, in GeV
+ * @param _high Upper edge of the histograms, in GeV
+ */
+void cacheinit(
+    ResultCache&    _cache,
+    const int&      _nbcid,
+    const unsigned& _nbins,
+    const double&   _low,
+    const double&   _high);
+
+/*
+ * This function creates the directory of an output file, like "out" for
+ * "./out/results.bin", when it does not exist yet. Only the last level
+ * of the path is created.
+ *
+ * @param _path Output file path
+ */
+void makeoutputdir(
+    const char* _path);
+
+/*
+ * This function writes a result cache to a binary file, creating its
+ * directory when needed.
+ *
+ * @param _path Cache file path
+ * @param _cache Result cache
+ */
+void writecache(
+    const char*        _path,
+    const ResultCache& _cache);
+
+/*
+ * This function reads a result cache from a binary file.
+ *
+ * @param _path Cache file path
+ * @param _cache Output result cache
+ */
+void readcache(
+    const char*  _path,
+    ResultCache& _cache);
+
+#endif
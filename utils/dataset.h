@@ -0,0 +1,119 @@
+/******************************************************************************
+ *                         TILECAL SIMULATOR
+ *
+ * Bernardo S. Peralva    <bernardo@iprj.uerj.br>
+ * Guilherme I. Gonçalves <ggoncalves@iprj.uerj.br>
+ *
+ * Copyright (C) 2018 Bernardo & Guilherme
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *   http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#ifndef TILECAL_UTILS_DATASET_H
+#define TILECAL_UTILS_DATASET_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "matrix.h"
+
+/*
+ * Binary noise dataset format.
+ *
+ * A dataset file is a fixed 64 bytes header followed by the samples
+ * matrix, stored row by row (one row per event) as native doubles:
+ *
+ *      | header (64 bytes) | row 0 | row 1 | ... | row (rows - 1) |
+ *
+ * Each row keeps the same column layout of the text dumps: the BCID
+ * is at column "bcidColumn" and the window samples start at column
+ * "firstSampleColumn". Since the rows are already laid out as a
+ * Matrix expects, the file can be mapped in memory and used as the
+ * matrix buffer without any parsing or copy.
+ *
+ * The format trades size for this zero-copy mapping: every column,
+ * including the BCID and the unused ones, is stored as a double, so a
+ * binary file is usually larger than its text dump. DATASET_DTYPE_F64
+ * is the only sample type, since a narrower one would have to be
+ * converted to doubles before use.
+ */
+const char     DATASET_MAGIC[8]            = { 'T', 'I', 'L', 'E', 'D', 'S', 'E', 'T' };
+const uint32_t DATASET_VERSION             = 1;
+const uint32_t DATASET_DTYPE_F64           = 1;
+const uint32_t DATASET_BCID_COLUMN         = 0;
+const uint32_t DATASET_FIRST_SAMPLE_COLUMN = 3;
+
+struct DatasetHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t dtype;
+    uint64_t rows;
+    uint32_t cols;
+    uint32_t bcidColumn;
+    uint32_t firstSampleColumn;
+    uint32_t reserved[7];
+};
+
+static_assert(sizeof(DatasetHeader) == 64, "dataset header must have 64 bytes");
+
+/*
+ * A dataset mapped in memory. The matrix is a view over the mapped
+ * rows, and it is valid until the dataset is unmapped.
+ */
+struct MappedDataset
+{
+    DatasetHeader header;
+    void*         address = nullptr;
+    size_t        length  = 0;
+    Matrix        matrix;
+};
+
+/*
+ * This function converts a noise dataset from the text format (one
+ * event per line, columns separated by spaces) to the binary format.
+ * The text file is streamed line by line, so the whole dataset is never
+ * held in memory.
+ *
+ * @param _textPath Input text file path
+ * @param _binaryPath Output binary file path
+ */
+void convertdataset(
+    const char* _textPath,
+    const char* _binaryPath);
+
+/*
+ * This function maps a binary noise dataset in memory. No sample is
+ * read at this point: pages are loaded by the kernel only when the
+ * matrix rows are touched.
+ *
+ * The mapping is private, so writing in the matrix never changes the
+ * dataset file. Files whose BCID or first sample column lies outside the
+ * rows are rejected; the window length is checked by the callers.
+ *
+ * @param _path Binary dataset file path
+ * @param _dataset Output mapped dataset
+ */
+void mapdataset(
+    const char*    _path,
+    MappedDataset& _dataset);
+
+/*
+ * This function releases a dataset mapped by "mapdataset". The dataset
+ * matrix must not be used after that.
+ *
+ * @param _dataset Mapped dataset
+ */
+void unmapdataset(MappedDataset& _dataset);
+
+#endif
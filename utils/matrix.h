@@ -0,0 +1,190 @@
+/******************************************************************************
+ *                         TILECAL SIMULATOR
+ *
+ * Bernardo S. Peralva    <bernardo@iprj.uerj.br>
+ * Guilherme I. Gonçalves <ggoncalves@iprj.uerj.br>
+ *
+ * Copyright (C) 2018 Bernardo & Guilherme
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *   http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#ifndef TILECAL_UTILS_MATRIX_H
+#define TILECAL_UTILS_MATRIX_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/*
+ * Vector of samples, contiguous in memory.
+ */
+typedef std::vector<double> Vector;
+
+/*
+ * Matrix of samples, stored row by row in a contiguous buffer, so
+ * m[i] is a pointer to the row "i" and m[i][j] is the element (i, j).
+ *
+ * A matrix either owns its buffer or is a view over an external one
+ * (see "use"), like a mapped file or a partition of another buffer.
+ * Copying a view gives a matrix which owns a copy of the elements.
+ */
+class Matrix
+{
+public:
+    Matrix()
+        : m_rows(0), m_cols(0), m_data(nullptr), m_owner(true)
+    {
+    }
+
+    Matrix(size_t _rows, size_t _cols)
+        : m_rows(_rows), m_cols(_cols), m_storage(_rows * _cols, 0.0), m_data(m_storage.data()), m_owner(true)
+    {
+    }
+
+    Matrix(const Matrix& _other)
+        : m_rows(_other.m_rows), m_cols(_other.m_cols),
+          m_storage(_other.m_data, _other.m_data + _other.size()),
+          m_data(m_storage.data()), m_owner(true)
+    {
+    }
+
+    Matrix(Matrix&& _other) noexcept
+        : m_rows(0), m_cols(0), m_data(nullptr), m_owner(true)
+    {
+        *this = std::move(_other);
+    }
+
+    Matrix& operator=(const Matrix& _other)
+    {
+        if (this != &_other)
+        {
+            m_rows    = _other.m_rows;
+            m_cols    = _other.m_cols;
+            m_storage.assign(_other.m_data, _other.m_data + _other.size());
+            m_data    = m_storage.data();
+            m_owner   = true;
+        }
+        return *this;
+    }
+
+    Matrix& operator=(Matrix&& _other) noexcept
+    {
+        if (this != &_other)
+        {
+            m_rows    = _other.m_rows;
+            m_cols    = _other.m_cols;
+            m_owner   = _other.m_owner;
+            m_storage = std::move(_other.m_storage);
+            m_data    = m_owner ? m_storage.data() : _other.m_data;
+
+            _other.m_rows  = 0;
+            _other.m_cols  = 0;
+            _other.m_data  = nullptr;
+            _other.m_owner = true;
+            _other.m_storage.clear();
+        }
+        return *this;
+    }
+
+    /*
+     * Resizes the matrix, which owns its buffer after that. All the
+     * elements are set to zero.
+     */
+    void resize(size_t _rows, size_t _cols)
+    {
+        m_rows  = _rows;
+        m_cols  = _cols;
+        m_storage.assign(_rows * _cols, 0.0);
+        m_data  = m_storage.data();
+        m_owner = true;
+    }
+
+    /*
+     * Makes the matrix a view over an external buffer, with _rows x _cols
+     * elements stored row by row. The buffer must outlive the view.
+     */
+    void use(size_t _rows, size_t _cols, double* _data)
+    {
+        m_rows  = _rows;
+        m_cols  = _cols;
+        m_storage.clear();
+        m_storage.shrink_to_fit();
+        m_data  = _data;
+        m_owner = false;
+    }
+
+    size_t rows() const { return m_rows; }
+    size_t cols() const { return m_cols; }
+    size_t size() const { return m_rows * m_cols; }
+    bool   owner() const { return m_owner; }
+
+    double*       data()       { return m_data; }
+    const double* data() const { return m_data; }
+
+    double*       operator[](size_t _i)       { return m_data + _i * m_cols; }
+    const double* operator[](size_t _i) const { return m_data + _i * m_cols; }
+
+private:
+    size_t              m_rows;
+    size_t              m_cols;
+    std::vector<double> m_storage;
+    double*             m_data;
+    bool                m_owner;
+};
+
+/*
+ * This function reads a matrix from a text file, with one row per line
+ * and the columns separated by spaces. Blank lines are skipped.
+ *
+ * @param _path File path
+ * @param _out Output matrix
+ */
+void readmatrix(
+    const char* _path,
+    Matrix&     _out);
+
+/*
+ * This function reads a vector from a text file, with the elements
+ * separated by spaces or line breaks.
+ *
+ * @param _path File path
+ * @param _out Output vector
+ */
+void readvector(
+    const char* _path,
+    Vector&     _out);
+
+/*
+ * This function writes a matrix to a text file, with one row per line
+ * and the columns separated by spaces, as read by "readmatrix".
+ *
+ * @param _path File path
+ * @param _matrix Matrix
+ */
+void writematrix(
+    const char*   _path,
+    const Matrix& _matrix);
+
+/*
+ * This function writes a vector to a text file, with one element per
+ * line, as read by "readvector".
+ *
+ * @param _path File path
+ * @param _vector Vector
+ */
+void writevector(
+    const char*   _path,
+    const Vector& _vector);
+
+#endif
@@ -0,0 +1,152 @@
+/******************************************************************************
+ *                         TILECAL SIMULATOR
+ *
+ * Bernardo S. Peralva    <bernardo@iprj.uerj.br>
+ * Guilherme I. Gonçalves <ggoncalves@iprj.uerj.br>
+ *
+ * Copyright (C) 2018 Bernardo & Guilherme
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *   http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#ifndef TILECAL_UTILS_STATISTICS_H
+#define TILECAL_UTILS_STATISTICS_H
+
+#include <cstdint>
+#include <vector>
+
+#include "matrix.h"
+
+/*
+ * Mean of the data samples, or zero when there is no sample.
+ */
+double mean(const Vector& _data);
+
+/*
+ * Standard deviation of the data samples, or zero when there is no sample.
+ */
+double rms(const Vector& _data);
+
+/*
+ * Mean, variance and range of a stream of samples, updated one sample
+ * at a time (Welford), so the samples do not need to be stored.
+ * Statistics of disjoint streams can be merged (Chan et al).
+ */
+struct RunningStats
+{
+    int64_t count = 0;
+    double  mean  = 0.0;
+    double  m2    = 0.0;
+    double  min   = 0.0;
+    double  max   = 0.0;
+};
+
+/*
+ * Histogram of a stream of samples, with bins of the same width in
+ * [low, high). Samples out of the range are counted apart.
+ */
+struct Histogram
+{
+    double                low       = 0.0;
+    double                high      = 0.0;
+    uint64_t              underflow = 0;
+    uint64_t              overflow  = 0;
+    std::vector<uint64_t> bins;
+};
+
+/*
+ * This function resets running statistics.
+ *
+ * @param _stats Running statistics
+ */
+void statsinit(RunningStats& _stats);
+
+/*
+ * This function adds a sample to running statistics.
+ *
+ * @param _stats Running statistics
+ * @param _x Sample
+ */
+void statsaccumulate(
+    RunningStats& _stats,
+    const double& _x);
+
+/*
+ * This function adds running statistics of another stream of samples.
+ *
+ * @param _stats Running statistics
+ * @param _other Statistics to add
+ */
+void statsmerge(
+    RunningStats&       _stats,
+    const RunningStats& _other);
+
+/*
+ * Standard deviation of the samples, or zero when there are less than
+ * two samples. It is the same value given by "rms" for all the samples.
+ */
+double statsrms(const RunningStats& _stats);
+
+/*
+ * This function resets a histogram.
+ *
+ * @param _hist Histogram
+ * @param _nbins Number of bins
+ * @param _low Lower edge of the first bin
+ * @param _high Upper edge of the last bin
+ */
+void histinit(
+    Histogram&      _hist,
+    const unsigned& _nbins,
+    const double&   _low,
+    const double&   _high);
+
+/*
+ * This function adds a sample to a histogram.
+ *
+ * @param _hist Histogram
+ * @param _x Sample
+ */
+void histfill(
+    Histogram&    _hist,
+    const double& _x);
+
+/*
+ * This function adds the counts of another histogram, which must have
+ * the same bins.
+ *
+ * @param _hist Histogram
+ * @param _other Histogram to add
+ */
+void histmerge(
+    Histogram&       _hist,
+    const Histogram& _other);
+
+/*
+ * Number of samples of a histogram, including the ones out of the range.
+ */
+uint64_t histcount(const Histogram& _hist);
+
+/*
+ * Estimate of a quantile of the samples, interpolated inside the bin
+ * which holds it, so its error is below the bin width. Quantiles out of
+ * the range of the histogram are clamped to its edges.
+ *
+ * @param _hist Histogram
+ * @param _q Quantile, in [0, 1]
+ */
+double histquantile(
+    const Histogram& _hist,
+    const double&    _q);
+
+#endif